@@ -2,6 +2,7 @@
 //
 
 #include "basic_directed_graph.h"
+#include "static_directed_graph.h"
 
 using namespace std;
 int main()
@@ -87,5 +88,56 @@ Size: 4
 	// Count all nodes with values > 22.
 	auto count{ std::count_if(std::begin(graph), std::end(graph),
 		[](const auto& node) { return node > 22; }) };
+
+	// Query reachability, then keep an index to make further queries a bit test.
+	graph.enable_reachability_index();
+	std::cout << std::boolalpha << "11 reaches 55: " << graph.reachable(11, 55) << std::endl;
+	graph.insert_edge(33, 55);
+	std::cout << "11 reaches 55: " << graph.reachable(11, 55) << std::endl;
+
+	// Renumber nodes for locality. permutation[old_index] is the new index.
+	const auto permutation{ graph.reorder(reorder_strategy::reverse_cuthill_mckee) };
+	for (size_t old_index{ 0 }; old_index < permutation.size(); ++old_index) {
+		std::cout << old_index << " -> " << permutation[old_index] << std::endl;
+	}
+
+	// Dense graphs can keep their edges in a bit matrix instead.
+	graph.set_storage(adjacency_storage::dense);
+	graph.insert_edge(11, 22);
+	graph.insert_edge(11, 55);
+	std::cout << "Edges: " << graph.edge_count() << ", triangles: " << graph.count_triangles() << std::endl;
+	graph.set_storage(adjacency_storage::sparse);
+
+	// Fill one builder per thread, then merge them all at once.
+	std::vector<directed_graph_builder<int>> builders(2);
+	builders[0].insert(66);
+	builders[0].insert_edge(11, 66);
+	builders[1].insert(66);
+	builders[1].insert(77);
+	builders[1].insert_edge(66, 77);
+	graph.merge(builders);
+	std::cout << "Size after merge: " << graph.size() << std::endl;
+
+	// Graphs known at build time can be built and queried at compile time.
+	constexpr auto state_machine{ [] {
+		static_directed_graph<char, 4> machine;
+		machine.insert('i');
+		machine.insert('r');
+		machine.insert('p');
+		machine.insert('s');
+		machine.insert_edge('i', 'r');
+		machine.insert_edge('r', 'p');
+		machine.insert_edge('r', 's');
+		return machine;
+	}() };
+	static_assert(state_machine.reachable('i', 's'));
+	static_assert(!state_machine.reachable('s', 'i'));
+	constexpr auto state_order{ *state_machine.topological_order() };
+	for (size_t index{ 0 }; index < state_machine.size(); ++index) {
+		std::cout << state_machine[state_order[index]] << " ";
+	}
+	std::cout << std::endl;
+	state_machine.for_each_adjacent('r', [](char state) { std::cout << state << " "; });
+	std::cout << std::endl;
 }
 
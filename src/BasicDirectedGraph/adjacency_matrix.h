@@ -0,0 +1,240 @@
+#pragma once
+#include <set>
+#include <vector>
+#include <span>
+#include <bit>
+#include <algorithm>
+#include "bit_row.h"
+
+// Adjacency representations of directed_graph.
+enum class adjacency_storage {
+	sparse, // std::set of adjacent indices per node
+	dense   // Packed bit matrix, size()^2 bits
+};
+
+namespace details {
+
+	// Packed bit matrix adjacency for dense graphs.
+	// Row i holds one bit per node j, set when there is an edge i -> j.
+	// Rows are contiguous arrays of 64-bit words, so row-wise AND/OR loops
+	// are simple enough for the compiler to vectorize.
+	class adjacency_matrix {
+	public:
+		using word_type = bit_word;
+
+		adjacency_matrix() = default;
+
+		// Builds a matrix with node_count rows and no edges.
+		explicit adjacency_matrix(size_t node_count);
+
+		// Builds a matrix with node_count rows from per-node adjacency sets.
+		template<typename AdjacencyOf>
+		adjacency_matrix(size_t node_count, AdjacencyOf&& adjacency_of);
+
+		[[nodiscard]] size_t size() const noexcept;
+
+		// Appends an empty row and column for a node added at the end.
+		void add_node();
+
+		// Removes the row and column of the node, shifting higher indices down by one.
+		// Returns the number of edges removed.
+		size_t erase_node(size_t index);
+
+		// Removes all nodes.
+		void clear() noexcept;
+
+		// No bounds checking is done on any of the edge operations.
+		[[nodiscard]] bool test(size_t from, size_t to) const noexcept;
+
+		// True if the edge was not present before.
+		bool set(size_t from, size_t to) noexcept;
+
+		// True if the edge was present before.
+		bool reset(size_t from, size_t to) noexcept;
+
+		// Number of outgoing edges of the node.
+		[[nodiscard]] size_t out_degree(size_t from) const noexcept;
+
+		// Calls function(to) for every edge from -> to, in increasing order of to.
+		template<typename Function>
+		void for_each_adjacent(size_t from, Function&& function) const;
+
+		// Calls function(to) for every node that both nodes have an edge to.
+		template<typename Function>
+		void for_each_common_adjacent(size_t first, size_t second, Function&& function) const;
+
+		// Number of (a, b, c) with distinct a, b, c and edges a -> b, a -> c, b -> c.
+		[[nodiscard]] size_t count_triangles() const noexcept;
+
+		// Adjacency set of the node, as stored by graph_node in sparse mode.
+		[[nodiscard]] std::set<size_t> adjacent_indices(size_t from) const;
+
+		// Matrix with rows and columns renumbered: permutation[old_index] == new_index.
+		[[nodiscard]] adjacency_matrix permuted(const std::vector<size_t>& permutation) const;
+
+		// Words of the row of the node. Bits past size() are always zero.
+		[[nodiscard]] std::span<word_type> row(size_t index) noexcept;
+		[[nodiscard]] std::span<const word_type> row(size_t index) const noexcept;
+
+	private:
+		// Resets storage to node_count empty rows.
+		void reset_storage(size_t node_count);
+
+		// ---------- Data Members ----------
+		size_t m_nodeCount{ 0 };
+		size_t m_wordsPerRow{ 0 };
+		std::vector<word_type> m_bits; // m_nodeCount rows of m_wordsPerRow words each
+	};
+}
+
+namespace details {
+
+	inline adjacency_matrix::adjacency_matrix(size_t node_count)
+	{
+		reset_storage(node_count);
+	}
+
+	template<typename AdjacencyOf>
+	inline adjacency_matrix::adjacency_matrix(size_t node_count, AdjacencyOf&& adjacency_of)
+	{
+		reset_storage(node_count);
+		for (size_t from{ 0 }; from < node_count; ++from) {
+			for (auto&& to : adjacency_of(from)) { set(from, to); }
+		}
+	}
+
+	inline size_t adjacency_matrix::size() const noexcept { return m_nodeCount; }
+
+	inline std::span<adjacency_matrix::word_type> adjacency_matrix::row(size_t index) noexcept
+	{
+		return { m_bits.data() + index * m_wordsPerRow, m_wordsPerRow };
+	}
+
+	inline std::span<const adjacency_matrix::word_type> adjacency_matrix::row(size_t index) const noexcept
+	{
+		return { m_bits.data() + index * m_wordsPerRow, m_wordsPerRow };
+	}
+
+	inline void adjacency_matrix::reset_storage(size_t node_count)
+	{
+		m_nodeCount = node_count;
+		m_wordsPerRow = words_for_bits(node_count);
+		m_bits.assign(m_nodeCount * m_wordsPerRow, 0);
+	}
+
+	inline void adjacency_matrix::add_node()
+	{
+		if (m_nodeCount >= m_wordsPerRow * bits_per_word) {
+			// Widen every row. Double the width to keep insertion amortized O(n).
+			const size_t new_words{ std::max<size_t>(1, m_wordsPerRow * 2) };
+			std::vector<word_type> widened(m_nodeCount * new_words, 0);
+			for (size_t index{ 0 }; index < m_nodeCount; ++index) {
+				std::copy_n(row(index).data(), m_wordsPerRow, widened.data() + index * new_words);
+			}
+			m_bits.swap(widened);
+			m_wordsPerRow = new_words;
+		}
+		++m_nodeCount;
+		m_bits.resize(m_nodeCount * m_wordsPerRow, 0);
+	}
+
+	inline size_t adjacency_matrix::erase_node(size_t index)
+	{
+		size_t removed{ out_degree(index) };
+
+		// Move the following rows up by one.
+		std::copy(m_bits.begin() + (index + 1) * m_wordsPerRow, m_bits.end(),
+			m_bits.begin() + index * m_wordsPerRow);
+		--m_nodeCount;
+		m_bits.resize(m_nodeCount * m_wordsPerRow);
+
+		// Remove the column and renumber the higher ones.
+		for (size_t from{ 0 }; from < m_nodeCount; ++from) {
+			removed += test(from, index);
+			remove_column(row(from), index);
+		}
+		return removed;
+	}
+
+	inline void adjacency_matrix::clear() noexcept
+	{
+		m_nodeCount = 0;
+		m_wordsPerRow = 0;
+		m_bits.clear();
+	}
+
+	inline bool adjacency_matrix::test(size_t from, size_t to) const noexcept
+	{
+		return test_bit(row(from), to);
+	}
+
+	inline bool adjacency_matrix::set(size_t from, size_t to) noexcept
+	{
+		return set_bit(row(from), to);
+	}
+
+	inline bool adjacency_matrix::reset(size_t from, size_t to) noexcept
+	{
+		return reset_bit(row(from), to);
+	}
+
+	inline size_t adjacency_matrix::out_degree(size_t from) const noexcept
+	{
+		return count_bits(row(from));
+	}
+
+	template<typename Function>
+	inline void adjacency_matrix::for_each_adjacent(size_t from, Function&& function) const
+	{
+		for_each_bit(row(from), function);
+	}
+
+	template<typename Function>
+	inline void adjacency_matrix::for_each_common_adjacent(size_t first, size_t second, Function&& function) const
+	{
+		const std::span<const word_type> first_row{ row(first) };
+		const std::span<const word_type> second_row{ row(second) };
+		for (size_t word{ 0 }; word < m_wordsPerRow; ++word) {
+			for (word_type bits{ first_row[word] & second_row[word] }; bits != 0; bits &= bits - 1) {
+				function(word * bits_per_word + static_cast<size_t>(std::countr_zero(bits)));
+			}
+		}
+	}
+
+	inline size_t adjacency_matrix::count_triangles() const noexcept
+	{
+		size_t triangles{ 0 };
+		for (size_t a{ 0 }; a < m_nodeCount; ++a) {
+			const std::span<const word_type> a_row{ row(a) };
+			for_each_bit(a_row, [&](size_t b) {
+				if (b == a) return;
+				const std::span<const word_type> b_row{ row(b) };
+				size_t common{ 0 };
+				for (size_t word{ 0 }; word < m_wordsPerRow; ++word) {
+					common += static_cast<size_t>(std::popcount(a_row[word] & b_row[word]));
+				}
+				// c must differ from a and b: discard self-loop a -> a with b -> a, and a -> b with b -> b.
+				common -= test(a, a) && test(b, a);
+				common -= test(b, b);
+				triangles += common;
+			});
+		}
+		return triangles;
+	}
+
+	inline std::set<size_t> adjacency_matrix::adjacent_indices(size_t from) const
+	{
+		std::set<size_t> indices;
+		for_each_adjacent(from, [&indices](size_t to) { indices.insert(std::end(indices), to); });
+		return indices;
+	}
+
+	inline adjacency_matrix adjacency_matrix::permuted(const std::vector<size_t>& permutation) const
+	{
+		adjacency_matrix result{ m_nodeCount };
+		for (size_t from{ 0 }; from < m_nodeCount; ++from) {
+			for_each_adjacent(from, [&](size_t to) { result.set(permutation[from], permutation[to]); });
+		}
+		return result;
+	}
+}
@@ -6,8 +6,19 @@
 #include <format>
 #include <sstream>
 #include <string>
+#include <optional>
+#include <queue>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <concepts>
+#include <execution>
 #include "basic_graph_node.h" 
 #include "directed_graph_iterator.h"
+#include "reachability_index.h"
+#include "node_ordering.h"
+#include "adjacency_matrix.h"
+#include "directed_graph_builder.h"
 
 
 namespace details {
@@ -87,6 +98,73 @@ public:
 	// Returns set of the adjacent nodes of a given node
 	std::set<T> get_adjacent_nodes_values(const T& node_value) const;
 
+	// Returns set of the nodes both given nodes have an edge to
+	std::set<T> get_common_adjacent_nodes_values(const T& first_node_value, const T& second_node_value) const;
+
+	// True if there is an edge from one node to the other.
+	[[nodiscard]] bool has_edge(const T& from_node_value, const T& to_node_value) const;
+
+	// Number of edges in the graph
+	[[nodiscard]] size_type edge_count() const noexcept;
+
+	// Number of (a, b, c) of distinct nodes with edges a -> b, a -> c and b -> c
+	[[nodiscard]] size_type count_triangles() const;
+
+	// Switches the adjacency representation. Dense storage keeps a packed bit
+	// matrix: edge test/insert/erase are O(1) and neighbor scans use popcount
+	// and count-trailing-zeros, at the cost of size()^2 bits of memory.
+	void set_storage(adjacency_storage storage);
+	[[nodiscard]] adjacency_storage storage() const noexcept;
+
+	// Switches to dense storage once edge_count() >= density * size()^2 and
+	// back to sparse storage below half of that. 0 disables switching (default).
+	// Checked whenever a node or edge is inserted or erased.
+	void set_dense_threshold(double density);
+
+	// True if there is a path from one node to the other.
+	// A node always reaches itself. False if either node does not exist.
+	// Uses the reachability index if it is enabled and up to date,
+	// a breadth-first search otherwise.
+	bool reachable(const T& from_node_value, const T& to_node_value) const;
+
+	// Same query for the nodes with the given indices, skipping the node lookups.
+	// With an up to date reachability index this is a single bit test.
+	// No Bounds checking is done.
+	bool reachable_at(size_type from_index, size_type to_index) const;
+
+	// Maintains a bitset transitive closure alongside the graph, built on enabling.
+	// insert and insert_edge keep it up to date. erase, erase_edge, clear,
+	// reorder and merge make it stale: until refresh_reachability_index()
+	// is called, queries fall back to a search.
+	// Queries never modify the index, so concurrent const calls are safe.
+	// Costs size()^2 bits of memory.
+	void enable_reachability_index();
+	void disable_reachability_index() noexcept;
+	[[nodiscard]] bool has_reachability_index() const noexcept;
+
+	// Rebuilds a stale reachability index. Does nothing if it is up to date or disabled.
+	void refresh_reachability_index();
+
+	// True if the reachability index is enabled and up to date.
+	[[nodiscard]] bool is_reachability_index_current() const noexcept;
+
+	// Permutes the node indices to improve memory locality of traversals
+	// and rewrites all adjacency lists accordingly. Node values are not changed.
+	// Returns the permutation: permutation[old_index] == new_index.
+	// Invalidates all iterators and references.
+	std::vector<size_type> reorder(reorder_strategy strategy);
+
+	// Adds the nodes and edges collected by the builders, e.g. one per thread.
+	// Nodes are deduplicated by value against each other and this graph, new
+	// nodes are appended in builder order. Sorting, lookups and adjacency
+	// updates run in parallel. Requires operator< on T. Builders are left empty.
+	void merge(std::span<directed_graph_builder<T>> builders);
+
+	// Adds all nodes and edges of the given graphs (union).
+	template<typename... Graphs>
+		requires (std::same_as<Graphs, directed_graph> && ...)
+	void merge(const Graphs&... graphs);
+
 	// Comparison for 2 graphs. True if they have the same nodes
 	// Order does not matter
 	bool operator==(const directed_graph& rhs) const;
@@ -95,10 +173,18 @@ public:
 private:
 	friend class const_directed_graph_iterator<directed_graph>;
 	friend class directed_graph_iterator<directed_graph>;
+	friend class directed_graph_builder<T>;
 
 	using nodes_container_type = std::vector<details::graph_node<T>>;
 	nodes_container_type m_nodes;
 
+	std::optional<details::reachability_index> m_reachability;
+
+	// Present only while storage is dense. Node adjacency sets are empty then.
+	std::optional<details::adjacency_matrix> m_dense;
+	size_type m_edgeCount{ 0 };
+	double m_denseThreshold{ 0.0 };
+
 	typename nodes_container_type::iterator findNode(const T& node_value);
 	typename nodes_container_type::const_iterator findNode(const T& node_value) const;
 
@@ -107,7 +193,26 @@ private:
 	// Removes links to the node passed
 	void remove_all_links_to(typename nodes_container_type::const_iterator& node_iter);
 
-	std::set<T> get_adjacent_nodes_values(const typename details::graph_node<T>::adjacency_list_type& indices) const;
+	std::set<T> adjacent_nodes_values_of(size_t node_index) const;
+
+	// Calls function(index) for every node the given node has an edge to.
+	template<typename Function>
+	void for_each_adjacent(size_t node_index, Function&& function) const;
+
+	// Calls function(adjacency_of), where adjacency_of(index) returns a sorted
+	// range of the adjacent indices of a node, regardless of the current storage.
+	// Dense storage is flattened into one index array, never into std::set.
+	template<typename Function>
+	decltype(auto) with_adjacency_lists(Function&& function) const;
+
+	// Applies the dense threshold after the edge count changed.
+	void update_storage_for_density();
+
+	// Breadth-first search used when there is no reachability index.
+	bool reachable_by_search(size_t from_index, size_t to_index) const;
+
+	// Tells the reachability index (if any) that it is out of date.
+	void invalidate_reachability_index() noexcept;
 };
 
 
@@ -171,12 +276,24 @@ inline size_t directed_graph<T>::get_index_of_node(const typename nodes_containe
 template<typename T>
 inline void directed_graph<T>::remove_all_links_to(typename nodes_container_type::const_iterator& node_iter)
 {
-	// Iterating over all nodes
 	const size_t node_index{ get_index_of_node(node_iter) };
+	if (m_dense) {
+		m_edgeCount -= m_dense->erase_node(node_index);
+		return;
+	}
+
+	// Iterating over all nodes
 	for (auto&& node : m_nodes) {
 		auto& adjacencyIndices{ node.get_adjacent_nodes_indices() };
+		// Dropping the outgoing edges of the to-be-deleted node
+		if (&node == &*node_iter) {
+			m_edgeCount -= adjacencyIndices.size();
+			adjacencyIndices.clear();
+			continue;
+		}
+
 		// Removing References to the to-be-deleted node
-		adjacencyIndices.erase(node_index);
+		if (adjacencyIndices.erase(node_index) != 0) --m_edgeCount;
 
 		// Decreasing the index of after-the-deleted nodes by one to encounter for deletion.
 		std::vector<size_t> indices(std::begin(adjacencyIndices), std::end(adjacencyIndices));
@@ -193,14 +310,45 @@ inline void directed_graph<T>::remove_all_links_to(typename nodes_container_type
 }
 
 template<typename T>
-inline std::set<T> directed_graph<T>::get_adjacent_nodes_values
-(const typename details::graph_node<T>::adjacency_list_type& indices) const
+inline std::set<T> directed_graph<T>::adjacent_nodes_values_of(size_t node_index) const
 {
 	std::set<T> values;
-	for (auto&& index : indices) { values.insert(m_nodes[index].value()); }
+	for_each_adjacent(node_index, [this, &values](size_t index) { values.insert(m_nodes[index].value()); });
 	return values;
 }
 
+template<typename T>
+template<typename Function>
+inline void directed_graph<T>::for_each_adjacent(size_t node_index, Function&& function) const
+{
+	if (m_dense) {
+		m_dense->for_each_adjacent(node_index, function);
+		return;
+	}
+	for (auto&& index : m_nodes[node_index].get_adjacent_nodes_indices()) { function(index); }
+}
+
+template<typename T>
+template<typename Function>
+inline decltype(auto) directed_graph<T>::with_adjacency_lists(Function&& function) const
+{
+	if (!m_dense) {
+		return function([this](size_t index) -> const auto& { return m_nodes[index].get_adjacent_nodes_indices(); });
+	}
+
+	// Adjacent indices of node i are targets[offsets[i]] up to targets[offsets[i + 1]].
+	std::vector<size_t> offsets(m_nodes.size() + 1, 0);
+	std::vector<size_t> targets;
+	targets.reserve(m_edgeCount);
+	for (size_t index{ 0 }; index < m_nodes.size(); ++index) {
+		m_dense->for_each_adjacent(index, [&targets](size_t adjacent) { targets.push_back(adjacent); });
+		offsets[index + 1] = targets.size();
+	}
+	return function([&offsets, &targets](size_t index) {
+		return std::span<const size_t>{ targets.data() + offsets[index], targets.data() + offsets[index + 1] };
+	});
+}
+
 template<typename T>
 inline std::pair<typename directed_graph<T>::iterator, bool> directed_graph<T>::insert(T&& node_value)
 {
@@ -211,6 +359,9 @@ inline std::pair<typename directed_graph<T>::iterator, bool> directed_graph<T>::
 
 	// Use perfect forwarding
 	m_nodes.push_back(details::graph_node<T>(this, std::forward<T>(node_value)));
+	if (m_dense) m_dense->add_node();
+	if (m_reachability) m_reachability->node_inserted();
+	update_storage_for_density();
 	return { iterator{--std::end(m_nodes), this}, true };
 }
 template<typename T>
@@ -277,6 +428,8 @@ inline bool directed_graph<T>::erase(const T& node_value)
 
 	remove_all_links_to(iter);
 	m_nodes.erase(iter);
+	invalidate_reachability_index();
+	update_storage_for_density();
 	return true;
 }
 
@@ -287,18 +440,24 @@ inline typename directed_graph<T>::iterator directed_graph<T>::erase(const_itera
 		return iterator{ std::end(m_nodes), this };
 	}
 	remove_all_links_to(pos.m_nodeIterator);
-	return iterator{ m_nodes.erase(pos.m_nodeIterator), this };
+	invalidate_reachability_index();
+	const auto next{ m_nodes.erase(pos.m_nodeIterator) };
+	update_storage_for_density();
+	return iterator{ next, this };
 }
 
 template<typename T>
 inline typename directed_graph<T>::iterator directed_graph<T>::erase(const_iterator first, const_iterator last)
 {
-	for (auto iter{ first }; iter != last; ++iter) {
-		if (iter.m_nodeIterator != std::end(m_nodes)) {
-			remove_all_links_to(iter.m_nodeIterator);
-		}
+	// Back to front, so the indices of the nodes still to be unlinked do not shift.
+	for (auto node{ last.m_nodeIterator }; node != first.m_nodeIterator;) {
+		--node;
+		remove_all_links_to(node);
 	}
-	return iterator{ m_nodes.erase(first.m_nodeIterator, last.m_nodeIterator), this };
+	invalidate_reachability_index();
+	const auto next{ m_nodes.erase(first.m_nodeIterator, last.m_nodeIterator) };
+	update_storage_for_density();
+	return iterator{ next, this };
 }
 
 template<typename T>
@@ -320,8 +479,17 @@ inline bool directed_graph<T>::insert_edge(const T& from_node_value, const T& to
 	const auto to = findNode(to_node_value);
 	if (from == std::end(m_nodes) || to == std::end(m_nodes)) return false;
 
+	const size_t from_index = get_index_of_node(from);
 	const size_t to_index = get_index_of_node(to);
-	return from->get_adjacent_nodes_indices().insert(to_index).second;
+	const bool inserted{ m_dense
+		? m_dense->set(from_index, to_index)
+		: from->get_adjacent_nodes_indices().insert(to_index).second };
+	if (!inserted) return false;
+
+	++m_edgeCount;
+	if (m_reachability) m_reachability->edge_inserted(from_index, to_index);
+	update_storage_for_density();
+	return true;
 }
 
 template<typename T>
@@ -330,14 +498,28 @@ inline bool directed_graph<T>::erase_edge(const T& from_node_value, const T& to_
 	const auto from{ findNode(from_node_value) };
 	const auto to{ findNode(to_node_value) };
 	bool invalid_connection = (from == std::end(m_nodes) || to == std::end(m_nodes));
+	if (invalid_connection) return false;
 
 	const size_t to_index{ get_index_of_node(to) };
-	from->get_adjacent_nodes_indices().erase(to_index);
+	const bool erased{ m_dense
+		? m_dense->reset(get_index_of_node(from), to_index)
+		: from->get_adjacent_nodes_indices().erase(to_index) != 0 };
+	if (!erased) return false;
+
+	--m_edgeCount;
+	invalidate_reachability_index();
+	update_storage_for_density();
 	return true;
 }
 
 template<typename T>
-inline void directed_graph<T>::clear() noexcept { m_nodes.clear(); }
+inline void directed_graph<T>::clear() noexcept
+{
+	m_nodes.clear();
+	if (m_dense) m_dense->clear();
+	m_edgeCount = 0;
+	invalidate_reachability_index();
+}
 
 template<typename T>
 inline typename directed_graph<T>::reference directed_graph<T>::operator[](size_type index)
@@ -361,9 +543,9 @@ inline bool directed_graph<T>::operator==(const directed_graph& rhs) const
 		if (rhsNodeIter == std::end(rhs.m_nodes)) return false;
 
 		const auto adjacent_values_lhs{
-			get_adjacent_nodes_values(node.get_adjacent_nodes_indices()) };
+			get_adjacent_nodes_values(node.value()) };
 		const auto adjacent_values_rhs{
-			rhsNodeIter->get_adjacent_nodes_indices() };
+			rhs.get_adjacent_nodes_values(node.value()) };
 		if (adjacent_values_lhs != adjacent_values_rhs) return false;
 	}
 	return true;
@@ -378,7 +560,11 @@ inline bool directed_graph<T>::operator!=(const directed_graph& rhs) const
 template<typename T>
 inline void directed_graph<T>::swap(directed_graph& other_graph) noexcept
 {
-	m_nodes.swap(other_graph);
+	m_nodes.swap(other_graph.m_nodes);
+	m_reachability.swap(other_graph.m_reachability);
+	m_dense.swap(other_graph.m_dense);
+	std::swap(m_edgeCount, other_graph.m_edgeCount);
+	std::swap(m_denseThreshold, other_graph.m_denseThreshold);
 }
 
 template<typename T>
@@ -416,7 +602,7 @@ inline std::set<T> directed_graph<T>::get_adjacent_nodes_values(const T& node_va
 {
 	auto iter{ findNode(node_value) };
 	if (iter == std::end(m_nodes)) return std::set<T>{};
-	return get_adjacent_nodes_values(iter->get_adjacent_nodes_indices());
+	return adjacent_nodes_values_of(static_cast<size_t>(std::distance(std::cbegin(m_nodes), iter)));
 }
 
 template<typename T>
@@ -427,3 +613,346 @@ inline void directed_graph<T>::insert(Iter first, Iter second)
 	// Give begin() as dummy position -- insert ignores it
 	std::copy(first, second, std::insert_iterator{ *this, begin() });
 }
+
+template<typename T>
+inline bool directed_graph<T>::reachable(const T& from_node_value, const T& to_node_value) const
+{
+	const auto from{ findNode(from_node_value) };
+	const auto to{ findNode(to_node_value) };
+	if (from == std::end(m_nodes) || to == std::end(m_nodes)) return false;
+
+	return reachable_at(static_cast<size_type>(std::distance(std::cbegin(m_nodes), from)),
+		static_cast<size_type>(std::distance(std::cbegin(m_nodes), to)));
+}
+
+template<typename T>
+inline bool directed_graph<T>::reachable_at(size_type from_index, size_type to_index) const
+{
+	if (!is_reachability_index_current()) return reachable_by_search(from_index, to_index);
+	return m_reachability->reachable(from_index, to_index);
+}
+
+template<typename T>
+inline bool directed_graph<T>::reachable_by_search(size_t from_index, size_t to_index) const
+{
+	std::vector<bool> visited(m_nodes.size(), false);
+	std::queue<size_t> pending;
+	visited[from_index] = true;
+	pending.push(from_index);
+	while (!pending.empty()) {
+		const size_t index{ pending.front() };
+		pending.pop();
+		if (index == to_index) return true;
+		for_each_adjacent(index, [&visited, &pending](size_t adjacent) {
+			if (visited[adjacent]) return;
+			visited[adjacent] = true;
+			pending.push(adjacent);
+		});
+	}
+	return false;
+}
+
+template<typename T>
+inline void directed_graph<T>::enable_reachability_index()
+{
+	if (!m_reachability) m_reachability.emplace();
+	refresh_reachability_index();
+}
+
+template<typename T>
+inline void directed_graph<T>::disable_reachability_index() noexcept
+{
+	m_reachability.reset();
+}
+
+template<typename T>
+inline bool directed_graph<T>::has_reachability_index() const noexcept
+{
+	return m_reachability.has_value();
+}
+
+template<typename T>
+inline void directed_graph<T>::refresh_reachability_index()
+{
+	if (!m_reachability || m_reachability->is_valid()) return;
+	with_adjacency_lists([this](auto&& adjacency_of) {
+		m_reachability->rebuild(m_nodes.size(), adjacency_of);
+	});
+}
+
+template<typename T>
+inline bool directed_graph<T>::is_reachability_index_current() const noexcept
+{
+	return m_reachability && m_reachability->is_valid();
+}
+
+template<typename T>
+inline void directed_graph<T>::invalidate_reachability_index() noexcept
+{
+	if (m_reachability) m_reachability->invalidate();
+}
+
+template<typename T>
+inline std::vector<typename directed_graph<T>::size_type> directed_graph<T>::reorder(reorder_strategy strategy)
+{
+	const auto neighbors{ with_adjacency_lists([this](auto&& adjacency_of) {
+		return details::make_undirected_neighbors(m_nodes.size(), adjacency_of);
+	}) };
+	const auto order{ details::node_order(strategy, neighbors) };
+
+	std::vector<size_type> permutation(order.size());
+	for (size_t new_index{ 0 }; new_index < order.size(); ++new_index) {
+		permutation[order[new_index]] = new_index;
+	}
+
+	nodes_container_type reordered_nodes;
+	reordered_nodes.reserve(m_nodes.size());
+	for (auto&& old_index : order) {
+		reordered_nodes.push_back(std::move(m_nodes[old_index]));
+	}
+
+	if (m_dense) m_dense = m_dense->permuted(permutation);
+	for (auto&& node : reordered_nodes) {
+		auto& adjacencyIndices{ node.get_adjacent_nodes_indices() };
+		std::vector<size_t> indices;
+		indices.reserve(adjacencyIndices.size());
+		for (auto&& index : adjacencyIndices) { indices.push_back(permutation[index]); }
+		adjacencyIndices.clear();
+		adjacencyIndices.insert(std::begin(indices), std::end(indices));
+	}
+
+	m_nodes.swap(reordered_nodes);
+	invalidate_reachability_index();
+	return permutation;
+}
+
+template<typename T>
+inline std::set<T> directed_graph<T>::get_common_adjacent_nodes_values(const T& first_node_value, const T& second_node_value) const
+{
+	const auto first{ findNode(first_node_value) };
+	const auto second{ findNode(second_node_value) };
+	if (first == std::end(m_nodes) || second == std::end(m_nodes)) return std::set<T>{};
+
+	std::set<T> values;
+	const auto insert_value{ [this, &values](size_t index) { values.insert(m_nodes[index].value()); } };
+	if (m_dense) {
+		m_dense->for_each_common_adjacent(static_cast<size_t>(std::distance(std::cbegin(m_nodes), first)),
+			static_cast<size_t>(std::distance(std::cbegin(m_nodes), second)), insert_value);
+		return values;
+	}
+
+	const auto& first_indices{ first->get_adjacent_nodes_indices() };
+	const auto& second_indices{ second->get_adjacent_nodes_indices() };
+	std::vector<size_t> common;
+	std::set_intersection(std::begin(first_indices), std::end(first_indices),
+		std::begin(second_indices), std::end(second_indices), std::back_inserter(common));
+	std::for_each(std::begin(common), std::end(common), insert_value);
+	return values;
+}
+
+template<typename T>
+inline bool directed_graph<T>::has_edge(const T& from_node_value, const T& to_node_value) const
+{
+	const auto from{ findNode(from_node_value) };
+	const auto to{ findNode(to_node_value) };
+	if (from == std::end(m_nodes) || to == std::end(m_nodes)) return false;
+
+	const auto to_index{ static_cast<size_t>(std::distance(std::cbegin(m_nodes), to)) };
+	if (m_dense) {
+		return m_dense->test(static_cast<size_t>(std::distance(std::cbegin(m_nodes), from)), to_index);
+	}
+	return from->get_adjacent_nodes_indices().contains(to_index);
+}
+
+template<typename T>
+inline typename directed_graph<T>::size_type directed_graph<T>::edge_count() const noexcept
+{
+	return m_edgeCount;
+}
+
+template<typename T>
+inline typename directed_graph<T>::size_type directed_graph<T>::count_triangles() const
+{
+	if (m_dense) return m_dense->count_triangles();
+
+	size_type triangles{ 0 };
+	std::vector<size_t> common;
+	for (size_t a{ 0 }; a < m_nodes.size(); ++a) {
+		const auto& a_indices{ m_nodes[a].get_adjacent_nodes_indices() };
+		for (auto&& b : a_indices) {
+			if (b == a) continue;
+			const auto& b_indices{ m_nodes[b].get_adjacent_nodes_indices() };
+			common.clear();
+			std::set_intersection(std::begin(a_indices), std::end(a_indices),
+				std::begin(b_indices), std::end(b_indices), std::back_inserter(common));
+			triangles += static_cast<size_type>(std::count_if(std::begin(common), std::end(common),
+				[a, b](size_t c) { return c != a && c != b; }));
+		}
+	}
+	return triangles;
+}
+
+template<typename T>
+inline void directed_graph<T>::set_storage(adjacency_storage storage)
+{
+	if (storage == adjacency_storage::dense && !m_dense) {
+		m_dense.emplace(m_nodes.size(),
+			[this](size_t index) -> const auto& { return m_nodes[index].get_adjacent_nodes_indices(); });
+		for (auto&& node : m_nodes) { node.get_adjacent_nodes_indices().clear(); }
+	}
+	else if (storage == adjacency_storage::sparse && m_dense) {
+		for (size_t index{ 0 }; index < m_nodes.size(); ++index) {
+			m_nodes[index].get_adjacent_nodes_indices() = m_dense->adjacent_indices(index);
+		}
+		m_dense.reset();
+	}
+}
+
+template<typename T>
+inline adjacency_storage directed_graph<T>::storage() const noexcept
+{
+	return m_dense ? adjacency_storage::dense : adjacency_storage::sparse;
+}
+
+template<typename T>
+inline void directed_graph<T>::set_dense_threshold(double density)
+{
+	m_denseThreshold = density;
+	update_storage_for_density();
+}
+
+template<typename T>
+inline void directed_graph<T>::update_storage_for_density()
+{
+	if (m_denseThreshold <= 0.0 || m_nodes.empty()) return;
+
+	const double node_count{ static_cast<double>(m_nodes.size()) };
+	const double density{ static_cast<double>(m_edgeCount) / (node_count * node_count) };
+	if (!m_dense && density >= m_denseThreshold) {
+		set_storage(adjacency_storage::dense);
+	}
+	else if (m_dense && density < m_denseThreshold / 2) {
+		set_storage(adjacency_storage::sparse);
+	}
+}
+
+template<typename T>
+inline void directed_graph<T>::merge(std::span<directed_graph_builder<T>> builders)
+{
+	constexpr size_t npos{ static_cast<size_t>(-1) };
+	const auto policy{ std::execution::par };
+
+	// Every builder gets a contiguous range in the flattened node and edge arrays.
+	std::vector<size_t> node_offsets(builders.size() + 1, m_nodes.size());
+	std::vector<size_t> edge_offsets(builders.size() + 1, 0);
+	for (size_t builder{ 0 }; builder < builders.size(); ++builder) {
+		node_offsets[builder + 1] = node_offsets[builder] + builders[builder].m_nodes.size();
+		edge_offsets[builder + 1] = edge_offsets[builder] + builders[builder].m_edges.size();
+	}
+	std::vector<size_t> builder_indices(builders.size());
+	std::iota(std::begin(builder_indices), std::end(builder_indices), size_t{ 0 });
+
+	// Node values in sequence: the graph's own nodes first, then every builder's.
+	std::vector<T*> values(node_offsets.back());
+	std::vector<const std::pair<T, T>*> edges(edge_offsets.back());
+	std::transform(policy, std::begin(m_nodes), std::end(m_nodes), std::begin(values),
+		[](auto& node) { return &node.value(); });
+	std::for_each(policy, std::begin(builder_indices), std::end(builder_indices), [&](size_t builder) {
+		auto& source{ builders[builder] };
+		std::transform(std::begin(source.m_nodes), std::end(source.m_nodes),
+			std::begin(values) + node_offsets[builder], [](T& value) { return &value; });
+		std::transform(std::begin(source.m_edges), std::end(source.m_edges),
+			std::begin(edges) + edge_offsets[builder], [](const auto& edge) { return &edge; });
+	});
+
+	// Sort sequence numbers by value. Ties are broken by sequence number, so the
+	// first entry of every run of equal values is its earliest occurrence.
+	std::vector<size_t> sorted(values.size());
+	std::iota(std::begin(sorted), std::end(sorted), size_t{ 0 });
+	std::sort(policy, std::begin(sorted), std::end(sorted), [&values](size_t lhs, size_t rhs) {
+		if (*values[lhs] < *values[rhs]) return true;
+		if (*values[rhs] < *values[lhs]) return false;
+		return lhs < rhs;
+	});
+
+	// A new node is the earliest occurrence of a value not already in the graph.
+	std::vector<size_t> is_new(values.size(), 0);
+	std::vector<size_t> positions(sorted.size());
+	std::iota(std::begin(positions), std::end(positions), size_t{ 0 });
+	std::for_each(policy, std::begin(positions), std::end(positions), [&](size_t position) {
+		const size_t sequence{ sorted[position] };
+		const bool first_of_value{ position == 0 || *values[sorted[position - 1]] < *values[sequence] };
+		is_new[sequence] = first_of_value && sequence >= m_nodes.size();
+	});
+	// Index of every new node among the new nodes
+	std::vector<size_t> new_rank(values.size());
+	std::exclusive_scan(policy, std::begin(is_new), std::end(is_new), std::begin(new_rank), size_t{ 0 });
+
+	// Final node index of a value, npos if it is not a node.
+	const auto index_of{ [&](const T& value) {
+		const auto found{ std::lower_bound(std::begin(sorted), std::end(sorted), value,
+			[&values](size_t sequence, const T& key) { return *values[sequence] < key; }) };
+		if (found == std::end(sorted) || value < *values[*found]) return npos;
+		return *found < m_nodes.size() ? *found : m_nodes.size() + new_rank[*found];
+	} };
+
+	// Resolve, sort and deduplicate the edges before node values are moved out.
+	std::vector<std::pair<size_t, size_t>> resolved(edges.size());
+	std::transform(policy, std::begin(edges), std::end(edges), std::begin(resolved), [&](const auto* edge) {
+		return std::pair{ index_of(edge->first), index_of(edge->second) };
+	});
+	resolved.erase(std::remove_if(policy, std::begin(resolved), std::end(resolved),
+		[](const auto& edge) { return edge.first == npos || edge.second == npos; }), std::end(resolved));
+	std::sort(policy, std::begin(resolved), std::end(resolved));
+	resolved.erase(std::unique(policy, std::begin(resolved), std::end(resolved)), std::end(resolved));
+
+	invalidate_reachability_index();
+	for (size_t sequence{ m_nodes.size() }; sequence < values.size(); ++sequence) {
+		if (!is_new[sequence]) continue;
+		m_nodes.push_back(details::graph_node<T>(this, std::move(*values[sequence])));
+		if (m_dense) m_dense->add_node();
+	}
+
+	// Every source node owns one adjacency set (or matrix row), so runs of
+	// edges with the same source can be inserted in parallel.
+	std::vector<size_t> run_starts;
+	for (size_t index{ 0 }; index < resolved.size(); ++index) {
+		if (index == 0 || resolved[index - 1].first != resolved[index].first) run_starts.push_back(index);
+	}
+	run_starts.push_back(resolved.size());
+	std::vector<size_t> runs(run_starts.size() - 1);
+	std::iota(std::begin(runs), std::end(runs), size_t{ 0 });
+	m_edgeCount += std::transform_reduce(policy, std::begin(runs), std::end(runs),
+		size_t{ 0 }, std::plus<>{}, [&](size_t run) {
+			const size_t run_start{ run_starts[run] };
+			const size_t run_end{ run_starts[run + 1] };
+			const size_t from{ resolved[run_start].first };
+			size_t inserted{ 0 };
+			if (m_dense) {
+				for (size_t index{ run_start }; index < run_end; ++index) {
+					inserted += m_dense->set(from, resolved[index].second);
+				}
+				return inserted;
+			}
+			auto& adjacencyIndices{ m_nodes[from].get_adjacent_nodes_indices() };
+			const size_t size_before{ adjacencyIndices.size() };
+			for (size_t index{ run_start }; index < run_end; ++index) {
+				adjacencyIndices.insert(std::end(adjacencyIndices), resolved[index].second);
+			}
+			return adjacencyIndices.size() - size_before;
+		});
+
+	for (auto&& builder : builders) { builder.clear(); }
+	update_storage_for_density();
+}
+
+template<typename T>
+template<typename... Graphs>
+	requires (std::same_as<Graphs, directed_graph<T>> && ...)
+inline void directed_graph<T>::merge(const Graphs&... graphs)
+{
+	std::vector<directed_graph_builder<T>> builders;
+	builders.reserve(sizeof...(graphs));
+	(builders.emplace_back(graphs), ...);
+	merge(std::span{ builders });
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <span>
+#include <bit>
+#include <cstdint>
+
+namespace details {
+
+	// Word operations on one row of a packed bit matrix, shared by
+	// adjacency_matrix and static_directed_graph.
+	// Column j is bit (j % bits_per_word) of word (j / bits_per_word).
+	// No bounds checking is done.
+	using bit_word = std::uint64_t;
+	inline constexpr size_t bits_per_word{ 64 };
+
+	// Number of words needed to hold the given number of columns.
+	[[nodiscard]] constexpr size_t words_for_bits(size_t bit_count) noexcept;
+
+	[[nodiscard]] constexpr bool test_bit(std::span<const bit_word> row, size_t column) noexcept;
+
+	// True if the bit was not set before.
+	constexpr bool set_bit(std::span<bit_word> row, size_t column) noexcept;
+
+	// True if the bit was set before.
+	constexpr bool reset_bit(std::span<bit_word> row, size_t column) noexcept;
+
+	// Number of set bits.
+	[[nodiscard]] constexpr size_t count_bits(std::span<const bit_word> row) noexcept;
+
+	// ORs source into target. Both rows must have the same number of words.
+	constexpr void or_bits(std::span<bit_word> target, std::span<const bit_word> source) noexcept;
+
+	// Removes the bit of the given column, shifting all higher columns down by one.
+	constexpr void remove_column(std::span<bit_word> row, size_t column) noexcept;
+
+	// Calls function(column) for every set bit, in increasing order of column.
+	template<typename Function>
+	constexpr void for_each_bit(std::span<const bit_word> row, Function&& function);
+}
+
+namespace details {
+
+	inline constexpr size_t words_for_bits(size_t bit_count) noexcept
+	{
+		return (bit_count + bits_per_word - 1) / bits_per_word;
+	}
+
+	inline constexpr bool test_bit(std::span<const bit_word> row, size_t column) noexcept
+	{
+		return (row[column / bits_per_word] >> (column % bits_per_word)) & 1;
+	}
+
+	inline constexpr bool set_bit(std::span<bit_word> row, size_t column) noexcept
+	{
+		bit_word& word{ row[column / bits_per_word] };
+		const bit_word bit{ bit_word{ 1 } << (column % bits_per_word) };
+		const bool inserted{ (word & bit) == 0 };
+		word |= bit;
+		return inserted;
+	}
+
+	inline constexpr bool reset_bit(std::span<bit_word> row, size_t column) noexcept
+	{
+		bit_word& word{ row[column / bits_per_word] };
+		const bit_word bit{ bit_word{ 1 } << (column % bits_per_word) };
+		const bool erased{ (word & bit) != 0 };
+		word &= ~bit;
+		return erased;
+	}
+
+	inline constexpr size_t count_bits(std::span<const bit_word> row) noexcept
+	{
+		size_t bits{ 0 };
+		for (auto&& word : row) { bits += static_cast<size_t>(std::popcount(word)); }
+		return bits;
+	}
+
+	inline constexpr void or_bits(std::span<bit_word> target, std::span<const bit_word> source) noexcept
+	{
+		for (size_t word{ 0 }; word < target.size(); ++word) { target[word] |= source[word]; }
+	}
+
+	inline constexpr void remove_column(std::span<bit_word> row, size_t column) noexcept
+	{
+		const size_t column_word{ column / bits_per_word };
+		const bit_word low_mask{ (bit_word{ 1 } << (column % bits_per_word)) - 1 };
+		row[column_word] = (row[column_word] & low_mask) | ((row[column_word] >> 1) & ~low_mask);
+		// Carry the lowest bit of every following word into the top of the previous one.
+		for (size_t word{ column_word }; word + 1 < row.size(); ++word) {
+			row[word] |= (row[word + 1] & 1) << (bits_per_word - 1);
+			row[word + 1] >>= 1;
+		}
+	}
+
+	template<typename Function>
+	inline constexpr void for_each_bit(std::span<const bit_word> row, Function&& function)
+	{
+		for (size_t word{ 0 }; word < row.size(); ++word) {
+			for (bit_word bits{ row[word] }; bits != 0; bits &= bits - 1) {
+				function(word * bits_per_word + static_cast<size_t>(std::countr_zero(bits)));
+			}
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <vector>
+#include <utility>
+
+template<typename T>
+class directed_graph;
+
+// Collects nodes and edges without any lookup or deduplication, so that
+// every thread can fill its own builder. The builders are then combined
+// with directed_graph::merge, which deduplicates nodes and edges.
+// A single builder is not thread-safe.
+template<typename T>
+class directed_graph_builder
+{
+public:
+	using value_type = T;
+	using size_type = size_t;
+
+	directed_graph_builder() = default;
+
+	// Collects all nodes and edges of the graph.
+	explicit directed_graph_builder(const directed_graph<T>& graph);
+
+	// Duplicates are allowed, merge keeps one node per value.
+	void insert(const T& node_value);
+	void insert(T&& node_value);
+
+	// Edges are kept on merge only if both nodes exist in the merged graph,
+	// as with directed_graph::insert_edge.
+	void insert_edge(const T& from_node_value, const T& to_node_value);
+
+	void reserve(size_type node_count, size_type edge_count);
+
+	// Number of collected nodes and edges, including duplicates.
+	[[nodiscard]] size_type node_count() const noexcept;
+	[[nodiscard]] size_type edge_count() const noexcept;
+	[[nodiscard]] bool empty() const noexcept;
+
+	void clear() noexcept;
+
+private:
+	// merge moves the collected values out of the builder
+	friend class directed_graph<T>;
+
+	// ---------- Data Members ----------
+	std::vector<T> m_nodes;
+	std::vector<std::pair<T, T>> m_edges;
+};
+
+template<typename T>
+inline directed_graph_builder<T>::directed_graph_builder(const directed_graph<T>& graph)
+{
+	reserve(graph.size(), graph.edge_count());
+	for (size_t index{ 0 }; index < graph.size(); ++index) {
+		m_nodes.push_back(graph[index]);
+	}
+	for (size_t index{ 0 }; index < graph.size(); ++index) {
+		graph.for_each_adjacent(index, [this, &graph, index](size_t adjacent) {
+			m_edges.emplace_back(graph[index], graph[adjacent]);
+		});
+	}
+}
+
+template<typename T>
+inline void directed_graph_builder<T>::insert(const T& node_value)
+{
+	m_nodes.push_back(node_value);
+}
+
+template<typename T>
+inline void directed_graph_builder<T>::insert(T&& node_value)
+{
+	m_nodes.push_back(std::move(node_value));
+}
+
+template<typename T>
+inline void directed_graph_builder<T>::insert_edge(const T& from_node_value, const T& to_node_value)
+{
+	m_edges.emplace_back(from_node_value, to_node_value);
+}
+
+template<typename T>
+inline void directed_graph_builder<T>::reserve(size_type node_count, size_type edge_count)
+{
+	m_nodes.reserve(node_count);
+	m_edges.reserve(edge_count);
+}
+
+template<typename T>
+inline typename directed_graph_builder<T>::size_type directed_graph_builder<T>::node_count() const noexcept
+{
+	return m_nodes.size();
+}
+
+template<typename T>
+inline typename directed_graph_builder<T>::size_type directed_graph_builder<T>::edge_count() const noexcept
+{
+	return m_edges.size();
+}
+
+template<typename T>
+inline bool directed_graph_builder<T>::empty() const noexcept
+{
+	return m_nodes.empty() && m_edges.empty();
+}
+
+template<typename T>
+inline void directed_graph_builder<T>::clear() noexcept
+{
+	m_nodes.clear();
+	m_edges.clear();
+}
@@ -0,0 +1,385 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+
+// Node orderings accepted by directed_graph::reorder.
+enum class reorder_strategy {
+	bfs,                   // Breadth-first order, so neighbors get nearby indices.
+	reverse_cuthill_mckee, // Bandwidth-reducing order (RCM).
+	degree,                // Most distinct neighbors first, so hubs share cache lines.
+	                       // Direction is ignored: a mutual edge pair counts once, self-loops not at all.
+	partition              // Multilevel recursive bisection, clusters laid out contiguously.
+};
+
+namespace details {
+
+	// Undirected view of the graph used by all orderings: edge direction
+	// does not matter for locality, both endpoints are touched by a traversal.
+	using neighbor_lists_type = std::vector<std::vector<size_t>>;
+
+	// Builds sorted, duplicate-free undirected neighbor lists.
+	// AdjacencyOf(i) must return a range of the adjacent indices of the node with index i.
+	template<typename AdjacencyOf>
+	neighbor_lists_type make_undirected_neighbors(size_t node_count, AdjacencyOf&& adjacency_of);
+
+	// All order functions return a vector where order[new_index] == old_index.
+	std::vector<size_t> bfs_order(const neighbor_lists_type& neighbors);
+	std::vector<size_t> reverse_cuthill_mckee_order(const neighbor_lists_type& neighbors);
+	std::vector<size_t> degree_order(const neighbor_lists_type& neighbors);
+	std::vector<size_t> partition_order(const neighbor_lists_type& neighbors);
+
+	// Dispatches on the strategy.
+	std::vector<size_t> node_order(reorder_strategy strategy, const neighbor_lists_type& neighbors);
+
+	// Small weighted undirected graph used by the multilevel partitioner.
+	struct weighted_graph {
+		std::vector<size_t> vertex_weights;
+		std::vector<std::vector<std::pair<size_t, size_t>>> edges; // (neighbor, weight)
+
+		[[nodiscard]] size_t size() const noexcept { return vertex_weights.size(); }
+	};
+
+	// Collapses a heavy-edge matching. coarse_of[v] receives the coarse vertex of v.
+	weighted_graph coarsen(const weighted_graph& graph, std::vector<size_t>& coarse_of);
+
+	// Splits the graph in two halves of roughly equal vertex weight.
+	// Result is the side (false/true) of every vertex.
+	std::vector<bool> bisect(const weighted_graph& graph);
+
+	// Initial bisection on the coarsest graph: grows one side by breadth-first search.
+	std::vector<bool> grow_bisection(const weighted_graph& graph);
+
+	// Greedy boundary refinement: moves vertices that reduce the cut while
+	// keeping both sides balanced.
+	void refine_bisection(const weighted_graph& graph, std::vector<bool>& side);
+
+	// Appends the vertices of the graph to order, recursively bisected.
+	// ids maps local vertex indices to node indices of the original graph.
+	void append_partition_order(const weighted_graph& graph, const std::vector<size_t>& ids,
+		std::vector<size_t>& order);
+}
+
+namespace details {
+
+	// Graphs at or below this size are not coarsened further.
+	inline constexpr size_t coarsest_graph_size{ 32 };
+
+	// Parts at or below this size are laid out in breadth-first order.
+	inline constexpr size_t partition_leaf_size{ 64 };
+
+	template<typename AdjacencyOf>
+	inline neighbor_lists_type make_undirected_neighbors(size_t node_count, AdjacencyOf&& adjacency_of)
+	{
+		neighbor_lists_type neighbors(node_count);
+		for (size_t index{ 0 }; index < node_count; ++index) {
+			for (auto&& adjacent : adjacency_of(index)) {
+				if (adjacent == index) continue;
+				neighbors[index].push_back(adjacent);
+				neighbors[adjacent].push_back(index);
+			}
+		}
+		for (auto&& list : neighbors) {
+			std::sort(std::begin(list), std::end(list));
+			list.erase(std::unique(std::begin(list), std::end(list)), std::end(list));
+		}
+		return neighbors;
+	}
+
+	inline std::vector<size_t> bfs_order(const neighbor_lists_type& neighbors)
+	{
+		std::vector<size_t> order;
+		order.reserve(neighbors.size());
+		std::vector<bool> visited(neighbors.size(), false);
+		for (size_t root{ 0 }; root < neighbors.size(); ++root) {
+			if (visited[root]) continue;
+			visited[root] = true;
+			order.push_back(root);
+			// order itself serves as the queue
+			for (size_t head{ order.size() - 1 }; head < order.size(); ++head) {
+				for (auto&& adjacent : neighbors[order[head]]) {
+					if (visited[adjacent]) continue;
+					visited[adjacent] = true;
+					order.push_back(adjacent);
+				}
+			}
+		}
+		return order;
+	}
+
+	inline std::vector<size_t> reverse_cuthill_mckee_order(const neighbor_lists_type& neighbors)
+	{
+		const size_t node_count{ neighbors.size() };
+		const auto degree_less{ [&neighbors](size_t lhs, size_t rhs) {
+			return std::pair{ neighbors[lhs].size(), lhs } < std::pair{ neighbors[rhs].size(), rhs };
+		} };
+
+		// Components are started from their lowest-degree node.
+		std::vector<size_t> roots(node_count);
+		std::iota(std::begin(roots), std::end(roots), size_t{ 0 });
+		std::sort(std::begin(roots), std::end(roots), degree_less);
+
+		std::vector<size_t> order;
+		order.reserve(node_count);
+		std::vector<bool> visited(node_count, false);
+		std::vector<size_t> next_level;
+		for (auto&& root : roots) {
+			if (visited[root]) continue;
+			visited[root] = true;
+			order.push_back(root);
+			for (size_t head{ order.size() - 1 }; head < order.size(); ++head) {
+				next_level.clear();
+				for (auto&& adjacent : neighbors[order[head]]) {
+					if (visited[adjacent]) continue;
+					visited[adjacent] = true;
+					next_level.push_back(adjacent);
+				}
+				std::sort(std::begin(next_level), std::end(next_level), degree_less);
+				order.insert(std::end(order), std::begin(next_level), std::end(next_level));
+			}
+		}
+		std::reverse(std::begin(order), std::end(order));
+		return order;
+	}
+
+	inline std::vector<size_t> degree_order(const neighbor_lists_type& neighbors)
+	{
+		std::vector<size_t> order(neighbors.size());
+		std::iota(std::begin(order), std::end(order), size_t{ 0 });
+		std::stable_sort(std::begin(order), std::end(order),
+			[&neighbors](size_t lhs, size_t rhs) { return neighbors[lhs].size() > neighbors[rhs].size(); });
+		return order;
+	}
+
+	inline std::vector<size_t> partition_order(const neighbor_lists_type& neighbors)
+	{
+		weighted_graph graph;
+		graph.vertex_weights.assign(neighbors.size(), 1);
+		graph.edges.resize(neighbors.size());
+		for (size_t index{ 0 }; index < neighbors.size(); ++index) {
+			for (auto&& adjacent : neighbors[index]) {
+				graph.edges[index].emplace_back(adjacent, 1);
+			}
+		}
+
+		std::vector<size_t> ids(neighbors.size());
+		std::iota(std::begin(ids), std::end(ids), size_t{ 0 });
+		std::vector<size_t> order;
+		order.reserve(neighbors.size());
+		append_partition_order(graph, ids, order);
+		return order;
+	}
+
+	inline std::vector<size_t> node_order(reorder_strategy strategy, const neighbor_lists_type& neighbors)
+	{
+		switch (strategy) {
+		case reorder_strategy::bfs: return bfs_order(neighbors);
+		case reorder_strategy::reverse_cuthill_mckee: return reverse_cuthill_mckee_order(neighbors);
+		case reorder_strategy::degree: return degree_order(neighbors);
+		case reorder_strategy::partition: return partition_order(neighbors);
+		}
+		// Unknown strategy: keep the current order.
+		std::vector<size_t> order(neighbors.size());
+		std::iota(std::begin(order), std::end(order), size_t{ 0 });
+		return order;
+	}
+
+	inline weighted_graph coarsen(const weighted_graph& graph, std::vector<size_t>& coarse_of)
+	{
+		constexpr size_t unmatched{ static_cast<size_t>(-1) };
+		coarse_of.assign(graph.size(), unmatched);
+
+		// Heavy-edge matching: pair each vertex with its heaviest unmatched neighbor.
+		size_t coarse_count{ 0 };
+		for (size_t vertex{ 0 }; vertex < graph.size(); ++vertex) {
+			if (coarse_of[vertex] != unmatched) continue;
+			size_t mate{ unmatched };
+			size_t mate_weight{ 0 };
+			for (auto&& [adjacent, weight] : graph.edges[vertex]) {
+				if (coarse_of[adjacent] == unmatched && adjacent != vertex && weight > mate_weight) {
+					mate = adjacent;
+					mate_weight = weight;
+				}
+			}
+			coarse_of[vertex] = coarse_count;
+			if (mate != unmatched) coarse_of[mate] = coarse_count;
+			++coarse_count;
+		}
+
+		weighted_graph coarse;
+		coarse.vertex_weights.assign(coarse_count, 0);
+		coarse.edges.resize(coarse_count);
+		for (size_t vertex{ 0 }; vertex < graph.size(); ++vertex) {
+			const size_t coarse_vertex{ coarse_of[vertex] };
+			coarse.vertex_weights[coarse_vertex] += graph.vertex_weights[vertex];
+			for (auto&& [adjacent, weight] : graph.edges[vertex]) {
+				const size_t coarse_adjacent{ coarse_of[adjacent] };
+				if (coarse_adjacent != coarse_vertex) {
+					coarse.edges[coarse_vertex].emplace_back(coarse_adjacent, weight);
+				}
+			}
+		}
+
+		// Merge parallel edges by summing their weights.
+		for (auto&& edges : coarse.edges) {
+			std::sort(std::begin(edges), std::end(edges));
+			size_t merged{ 0 };
+			for (size_t index{ 0 }; index < edges.size(); ++index) {
+				if (merged > 0 && edges[merged - 1].first == edges[index].first) {
+					edges[merged - 1].second += edges[index].second;
+				}
+				else {
+					edges[merged++] = edges[index];
+				}
+			}
+			edges.resize(merged);
+		}
+		return coarse;
+	}
+
+	inline std::vector<bool> bisect(const weighted_graph& graph)
+	{
+		if (graph.size() <= coarsest_graph_size) {
+			auto side{ grow_bisection(graph) };
+			refine_bisection(graph, side);
+			return side;
+		}
+
+		std::vector<size_t> coarse_of;
+		const weighted_graph coarse{ coarsen(graph, coarse_of) };
+
+		std::vector<bool> side;
+		// Stop coarsening when matching no longer shrinks the graph (e.g. stars).
+		if (coarse.size() * 10 > graph.size() * 9) {
+			side = grow_bisection(graph);
+		}
+		else {
+			const auto coarse_side{ bisect(coarse) };
+			side.resize(graph.size());
+			for (size_t vertex{ 0 }; vertex < graph.size(); ++vertex) {
+				side[vertex] = coarse_side[coarse_of[vertex]];
+			}
+		}
+		refine_bisection(graph, side);
+		return side;
+	}
+
+	inline std::vector<bool> grow_bisection(const weighted_graph& graph)
+	{
+		const size_t total_weight{
+			std::accumulate(std::begin(graph.vertex_weights), std::end(graph.vertex_weights), size_t{ 0 }) };
+		std::vector<bool> side(graph.size(), false);
+		std::vector<bool> visited(graph.size(), false);
+		size_t grown_weight{ 0 };
+
+		std::queue<size_t> pending;
+		for (size_t root{ 0 }; root < graph.size() && grown_weight * 2 < total_weight; ++root) {
+			if (visited[root]) continue;
+			visited[root] = true;
+			pending.push(root);
+			while (!pending.empty() && grown_weight * 2 < total_weight) {
+				const size_t vertex{ pending.front() };
+				pending.pop();
+				side[vertex] = true;
+				grown_weight += graph.vertex_weights[vertex];
+				for (auto&& [adjacent, weight] : graph.edges[vertex]) {
+					if (visited[adjacent]) continue;
+					visited[adjacent] = true;
+					pending.push(adjacent);
+				}
+			}
+			pending = {};
+		}
+		return side;
+	}
+
+	inline void refine_bisection(const weighted_graph& graph, std::vector<bool>& side)
+	{
+		constexpr size_t max_passes{ 4 };
+
+		size_t side_weight[2]{ 0, 0 };
+		size_t max_vertex_weight{ 0 };
+		for (size_t vertex{ 0 }; vertex < graph.size(); ++vertex) {
+			side_weight[side[vertex]] += graph.vertex_weights[vertex];
+			max_vertex_weight = std::max(max_vertex_weight, graph.vertex_weights[vertex]);
+		}
+		// Allow 10% imbalance plus one vertex.
+		const size_t max_side_weight{
+			(side_weight[0] + side_weight[1]) * 11 / 20 + max_vertex_weight };
+
+		for (size_t pass{ 0 }; pass < max_passes; ++pass) {
+			bool improved{ false };
+			for (size_t vertex{ 0 }; vertex < graph.size(); ++vertex) {
+				const bool from{ side[vertex] };
+				size_t internal{ 0 };
+				size_t external{ 0 };
+				for (auto&& [adjacent, weight] : graph.edges[vertex]) {
+					(side[adjacent] == from ? internal : external) += weight;
+				}
+				const size_t weight{ graph.vertex_weights[vertex] };
+				if (external <= internal || side_weight[!from] + weight > max_side_weight) continue;
+
+				side[vertex] = !from;
+				side_weight[from] -= weight;
+				side_weight[!from] += weight;
+				improved = true;
+			}
+			if (!improved) break;
+		}
+	}
+
+	inline void append_partition_order(const weighted_graph& graph, const std::vector<size_t>& ids,
+		std::vector<size_t>& order)
+	{
+		const auto append_bfs{ [&]() {
+			neighbor_lists_type neighbors(graph.size());
+			for (size_t vertex{ 0 }; vertex < graph.size(); ++vertex) {
+				for (auto&& [adjacent, weight] : graph.edges[vertex]) {
+					neighbors[vertex].push_back(adjacent);
+				}
+			}
+			for (auto&& vertex : bfs_order(neighbors)) { order.push_back(ids[vertex]); }
+		} };
+
+		if (graph.size() <= partition_leaf_size) {
+			append_bfs();
+			return;
+		}
+
+		const auto side{ bisect(graph) };
+		const auto true_count{ static_cast<size_t>(std::count(std::begin(side), std::end(side), true)) };
+		if (true_count == 0 || true_count == graph.size()) {
+			append_bfs();
+			return;
+		}
+
+		// Split into the two induced subgraphs and recurse. Side "true" goes first.
+		for (const bool part : { true, false }) {
+			constexpr size_t outside{ static_cast<size_t>(-1) };
+			std::vector<size_t> local_of(graph.size(), outside);
+			std::vector<size_t> part_ids;
+			for (size_t vertex{ 0 }; vertex < graph.size(); ++vertex) {
+				if (side[vertex] != part) continue;
+				local_of[vertex] = part_ids.size();
+				part_ids.push_back(vertex);
+			}
+
+			weighted_graph subgraph;
+			subgraph.vertex_weights.reserve(part_ids.size());
+			subgraph.edges.resize(part_ids.size());
+			for (size_t local{ 0 }; local < part_ids.size(); ++local) {
+				const size_t vertex{ part_ids[local] };
+				subgraph.vertex_weights.push_back(graph.vertex_weights[vertex]);
+				for (auto&& [adjacent, weight] : graph.edges[vertex]) {
+					if (local_of[adjacent] != outside) {
+						subgraph.edges[local].emplace_back(local_of[adjacent], weight);
+					}
+				}
+				part_ids[local] = ids[vertex];
+			}
+			append_partition_order(subgraph, part_ids, order);
+		}
+	}
+}
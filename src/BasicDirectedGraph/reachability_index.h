@@ -0,0 +1,158 @@
+#pragma once
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include "adjacency_matrix.h"
+
+namespace details {
+
+	// Bitset transitive closure over node indices.
+	// Row i holds one bit per node j, set when j is reachable from i.
+	// Every node reaches itself (path of length zero).
+	class reachability_index {
+	public:
+		// True if the closure matches the graph and can answer queries.
+		[[nodiscard]] bool is_valid() const noexcept;
+
+		// Marks the closure as stale until the next rebuild.
+		void invalidate() noexcept;
+
+		// Appends a row for a node added at the end of the node container.
+		void node_inserted();
+
+		// Incrementally adds edge from -> to.
+		// Every node that reaches "from" now also reaches everything "to" reaches.
+		void edge_inserted(size_t from, size_t to);
+
+		// No bounds checking is done. The closure must be valid.
+		[[nodiscard]] bool reachable(size_t from, size_t to) const noexcept;
+
+		// Recomputes the closure from scratch.
+		// AdjacencyOf(i) must return a range of the adjacent indices of the node with
+		// index i, whose iterators stay valid for the whole rebuild.
+		// Uses Tarjan's SCC algorithm: components are emitted in reverse topological
+		// order, so the rows of all successor components are final when a component
+		// is emitted and can simply be OR-ed together.
+		template<typename AdjacencyOf>
+		void rebuild(size_t node_count, AdjacencyOf&& adjacency_of);
+
+	private:
+		// ORs the closure row of source into the closure row of target.
+		void merge_row(size_t target, size_t source) noexcept;
+
+		// ---------- Data Members ----------
+		adjacency_matrix m_closure; // edge i -> j when j is reachable from i
+		bool m_valid{ false };
+	};
+}
+
+namespace details {
+
+	inline bool reachability_index::is_valid() const noexcept { return m_valid; }
+
+	inline void reachability_index::invalidate() noexcept { m_valid = false; }
+
+	inline void reachability_index::merge_row(size_t target, size_t source) noexcept
+	{
+		or_bits(m_closure.row(target), m_closure.row(source));
+	}
+
+	inline void reachability_index::node_inserted()
+	{
+		if (!m_valid) return;
+
+		const size_t new_index{ m_closure.size() };
+		m_closure.add_node();
+		m_closure.set(new_index, new_index);
+	}
+
+	inline void reachability_index::edge_inserted(size_t from, size_t to)
+	{
+		if (!m_valid || reachable(from, to)) return;
+
+		for (size_t index{ 0 }; index < m_closure.size(); ++index) {
+			if (m_closure.test(index, from)) merge_row(index, to);
+		}
+	}
+
+	inline bool reachability_index::reachable(size_t from, size_t to) const noexcept
+	{
+		return m_closure.test(from, to);
+	}
+
+	template<typename AdjacencyOf>
+	inline void reachability_index::rebuild(size_t node_count, AdjacencyOf&& adjacency_of)
+	{
+		m_closure = adjacency_matrix{ node_count };
+
+		constexpr size_t unvisited{ static_cast<size_t>(-1) };
+		std::vector<size_t> order(node_count, unvisited);
+		std::vector<size_t> low_link(node_count, 0);
+		std::vector<bool> on_stack(node_count, false);
+		std::vector<size_t> scc_stack;
+		size_t next_order{ 0 };
+
+		// Explicit DFS stack of (node, next adjacency iterator) to avoid recursion.
+		using adjacency_iterator = decltype(std::cbegin(adjacency_of(size_t{ 0 })));
+		std::vector<std::pair<size_t, adjacency_iterator>> dfs_stack;
+
+		for (size_t root{ 0 }; root < node_count; ++root) {
+			if (order[root] != unvisited) continue;
+
+			dfs_stack.emplace_back(root, std::cbegin(adjacency_of(root)));
+			order[root] = low_link[root] = next_order++;
+			scc_stack.push_back(root);
+			on_stack[root] = true;
+
+			while (!dfs_stack.empty()) {
+				auto& [node, next] { dfs_stack.back() };
+				const auto& adjacent{ adjacency_of(node) };
+
+				if (next != std::cend(adjacent)) {
+					const size_t successor{ *next++ };
+					if (order[successor] == unvisited) {
+						order[successor] = low_link[successor] = next_order++;
+						scc_stack.push_back(successor);
+						on_stack[successor] = true;
+						dfs_stack.emplace_back(successor, std::cbegin(adjacency_of(successor)));
+					}
+					else if (on_stack[successor]) {
+						low_link[node] = std::min(low_link[node], order[successor]);
+					}
+					continue;
+				}
+
+				const size_t finished{ node };
+				dfs_stack.pop_back();
+				if (!dfs_stack.empty()) {
+					const size_t parent{ dfs_stack.back().first };
+					low_link[parent] = std::min(low_link[parent], low_link[finished]);
+				}
+				if (low_link[finished] != order[finished]) continue;
+
+				// "finished" is the root of a component. Pop its members.
+				const auto members_begin{
+					std::find(std::begin(scc_stack), std::end(scc_stack), finished) };
+				std::vector<size_t> members(members_begin, std::end(scc_stack));
+				scc_stack.erase(members_begin, std::end(scc_stack));
+
+				// Build the component row in the root's row, then copy it to the others.
+				for (auto&& member : members) {
+					on_stack[member] = false;
+					m_closure.set(finished, member);
+				}
+				for (auto&& member : members) {
+					for (auto&& successor : adjacency_of(member)) { merge_row(finished, successor); }
+				}
+				const auto component_row{ m_closure.row(finished) };
+				for (auto&& member : members) {
+					if (member != finished) {
+						std::ranges::copy(component_row, std::begin(m_closure.row(member)));
+					}
+				}
+			}
+		}
+
+		m_valid = true;
+	}
+}
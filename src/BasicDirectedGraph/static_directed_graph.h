@@ -0,0 +1,394 @@
+#pragma once
+#include <set>
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include "bit_row.h"
+
+// Fixed-capacity directed graph without heap allocation, usable in constant expressions.
+// Meant for small graphs known at build time, e.g. state machines.
+// The only exception is get_adjacent_nodes_values, which returns a std::set and so
+// allocates and is runtime only. for_each_adjacent is its constexpr counterpart.
+// Adjacency is a bit matrix: row i has bit j set if there is an edge i -> j.
+// T must be a literal type that is default constructible and equality comparable.
+// MaxEdges caps the number of edges; insert_edge fails once it is reached.
+// It is only a limit: storage is always MaxNodes * MaxNodes bits, whatever MaxEdges is.
+template<typename T, size_t MaxNodes, size_t MaxEdges = MaxNodes * MaxNodes>
+class static_directed_graph
+{
+	static_assert(MaxNodes > 0, "static_directed_graph needs room for at least one node");
+
+public:
+	// STL native adaption
+	using value_type = T;
+	using reference = value_type&;
+	using const_reference = const value_type&;
+	using size_type = size_t;
+	using difference_type = ptrdiff_t;
+
+	// Node values identify nodes, so they are not modifiable through iterators.
+	using iterator = const value_type*;
+	using const_iterator = const value_type*;
+
+	// Indices into the graph, in topological order. Only the first size() entries are used.
+	using index_array_type = std::array<size_type, MaxNodes>;
+
+	constexpr static_directed_graph() = default;
+
+	// STL native methods
+	[[nodiscard]] constexpr size_type size() const noexcept;
+	[[nodiscard]] constexpr size_type max_size() const noexcept;
+	[[nodiscard]] constexpr bool empty() const noexcept;
+
+	// Number of edges in the graph
+	[[nodiscard]] constexpr size_type edge_count() const noexcept;
+
+	// STL native Bounds Checking
+	constexpr const_reference at(size_type index) const;
+
+	// Returns ref to the node with given index.
+	// No Bounds checking is done.
+	constexpr const_reference operator[](size_type index) const;
+
+	// Iterator Methods
+	constexpr const_iterator begin() const noexcept;
+	constexpr const_iterator end() const noexcept;
+	constexpr const_iterator cbegin() const noexcept;
+	constexpr const_iterator cend() const noexcept;
+
+	// Returns true if new node has been added.
+	// Returns false if there was already node with this value (iterator to it),
+	// or if the graph is full (end()).
+	constexpr std::pair<iterator, bool> insert(const T& node_value);
+	template<typename Iter> constexpr void insert(Iter first, Iter last);
+
+	// True if node was erased, false otherwise.
+	constexpr bool erase(const T& node_value);
+
+	// Removed all nodes from the graph
+	constexpr void clear() noexcept;
+
+	constexpr const_iterator find(const T& node_value) const;
+
+	// True if edge was inserted, false otherwise.
+	constexpr bool insert_edge(const T& from_node_value, const T& to_node_value);
+
+	// True if edge was erased, false otherwise.
+	constexpr bool erase_edge(const T& from_node_value, const T& to_node_value);
+
+	// True if there is an edge from one node to the other.
+	[[nodiscard]] constexpr bool has_edge(const T& from_node_value, const T& to_node_value) const;
+
+	// Returns set of the adjacent nodes of a given node
+	std::set<T> get_adjacent_nodes_values(const T& node_value) const;
+
+	// Calls function(adjacent_value) for every adjacent node of the given node, in index order.
+	// Does nothing if there is no such node.
+	template<typename Function>
+	constexpr void for_each_adjacent(const T& node_value, Function&& function) const;
+
+	// True if there is a path from one node to the other.
+	// A node always reaches itself. False if either node does not exist.
+	[[nodiscard]] constexpr bool reachable(const T& from_node_value, const T& to_node_value) const;
+
+	// Node indices in topological order (Kahn's algorithm), std::nullopt if the graph has a cycle.
+	[[nodiscard]] constexpr std::optional<index_array_type> topological_order() const;
+
+	// Comparison for 2 graphs. True if they have the same nodes and edges
+	// Order does not matter
+	constexpr bool operator==(const static_directed_graph& rhs) const;
+	constexpr bool operator!=(const static_directed_graph& rhs) const;
+
+private:
+	static constexpr size_type words_per_row{ details::words_for_bits(MaxNodes) };
+	static constexpr size_type npos{ static_cast<size_type>(-1) };
+
+	using row_type = std::array<details::bit_word, words_per_row>;
+
+	// Index of the node with the given value, npos if there is none.
+	constexpr size_type find_index(const T& node_value) const;
+
+	// ---------- Data Members ----------
+	std::array<T, MaxNodes> m_values{};
+	std::array<row_type, MaxNodes> m_adjacency{};
+	size_type m_size{ 0 };
+	size_type m_edgeCount{ 0 };
+};
+
+
+// -----------------------------------------
+//
+//    Static Graph Implementation
+//
+// -----------------------------------------
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+constexpr void swap(static_directed_graph<T, MaxNodes, MaxEdges>& lhs, static_directed_graph<T, MaxNodes, MaxEdges>& rhs)
+{
+	std::swap(lhs, rhs);
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::size_type
+static_directed_graph<T, MaxNodes, MaxEdges>::find_index(const T& node_value) const
+{
+	for (size_type index{ 0 }; index < m_size; ++index) {
+		if (m_values[index] == node_value) return index;
+	}
+	return npos;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::size_type
+static_directed_graph<T, MaxNodes, MaxEdges>::size() const noexcept
+{
+	return m_size;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::size_type
+static_directed_graph<T, MaxNodes, MaxEdges>::max_size() const noexcept
+{
+	return MaxNodes;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::empty() const noexcept
+{
+	return m_size == 0;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::size_type
+static_directed_graph<T, MaxNodes, MaxEdges>::edge_count() const noexcept
+{
+	return m_edgeCount;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::const_reference
+static_directed_graph<T, MaxNodes, MaxEdges>::at(size_type index) const
+{
+	if (index >= m_size) throw std::out_of_range{ "static_directed_graph::at" };
+	return m_values[index];
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::const_reference
+static_directed_graph<T, MaxNodes, MaxEdges>::operator[](size_type index) const
+{
+	return m_values[index];
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::const_iterator
+static_directed_graph<T, MaxNodes, MaxEdges>::begin() const noexcept
+{
+	return m_values.data();
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::const_iterator
+static_directed_graph<T, MaxNodes, MaxEdges>::end() const noexcept
+{
+	return m_values.data() + m_size;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::const_iterator
+static_directed_graph<T, MaxNodes, MaxEdges>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::const_iterator
+static_directed_graph<T, MaxNodes, MaxEdges>::cend() const noexcept
+{
+	return end();
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr std::pair<typename static_directed_graph<T, MaxNodes, MaxEdges>::iterator, bool>
+static_directed_graph<T, MaxNodes, MaxEdges>::insert(const T& node_value)
+{
+	const size_type index{ find_index(node_value) };
+	if (index != npos) return { begin() + index, false };
+	if (m_size == MaxNodes) return { end(), false };
+
+	m_values[m_size] = node_value;
+	m_adjacency[m_size] = row_type{};
+	return { begin() + m_size++, true };
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+template<typename Iter>
+inline constexpr void static_directed_graph<T, MaxNodes, MaxEdges>::insert(Iter first, Iter last)
+{
+	for (; first != last; ++first) { insert(*first); }
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::erase(const T& node_value)
+{
+	const size_type erased{ find_index(node_value) };
+	if (erased == npos) return false;
+
+	// Drop outgoing edges, then shift the following rows down.
+	m_edgeCount -= details::count_bits(m_adjacency[erased]);
+	for (size_type index{ erased }; index + 1 < m_size; ++index) {
+		m_values[index] = m_values[index + 1];
+		m_adjacency[index] = m_adjacency[index + 1];
+	}
+	--m_size;
+	m_adjacency[m_size] = row_type{};
+
+	// Drop incoming edges and renumber the columns after the erased node.
+	for (size_type index{ 0 }; index < m_size; ++index) {
+		if (details::test_bit(m_adjacency[index], erased)) --m_edgeCount;
+		details::remove_column(m_adjacency[index], erased);
+	}
+	return true;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr void static_directed_graph<T, MaxNodes, MaxEdges>::clear() noexcept
+{
+	for (size_type index{ 0 }; index < m_size; ++index) { m_adjacency[index] = row_type{}; }
+	m_size = 0;
+	m_edgeCount = 0;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr typename static_directed_graph<T, MaxNodes, MaxEdges>::const_iterator
+static_directed_graph<T, MaxNodes, MaxEdges>::find(const T& node_value) const
+{
+	const size_type index{ find_index(node_value) };
+	return index == npos ? end() : begin() + index;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::insert_edge(const T& from_node_value, const T& to_node_value)
+{
+	const size_type from{ find_index(from_node_value) };
+	const size_type to{ find_index(to_node_value) };
+	if (from == npos || to == npos) return false;
+	if (details::test_bit(m_adjacency[from], to) || m_edgeCount == MaxEdges) return false;
+
+	details::set_bit(m_adjacency[from], to);
+	++m_edgeCount;
+	return true;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::erase_edge(const T& from_node_value, const T& to_node_value)
+{
+	const size_type from{ find_index(from_node_value) };
+	const size_type to{ find_index(to_node_value) };
+	if (from == npos || to == npos || !details::reset_bit(m_adjacency[from], to)) return false;
+
+	--m_edgeCount;
+	return true;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::has_edge(const T& from_node_value, const T& to_node_value) const
+{
+	const size_type from{ find_index(from_node_value) };
+	const size_type to{ find_index(to_node_value) };
+	return from != npos && to != npos && details::test_bit(m_adjacency[from], to);
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline std::set<T> static_directed_graph<T, MaxNodes, MaxEdges>::get_adjacent_nodes_values(const T& node_value) const
+{
+	std::set<T> values;
+	for_each_adjacent(node_value, [&values](const T& adjacent) { values.insert(adjacent); });
+	return values;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+template<typename Function>
+inline constexpr void static_directed_graph<T, MaxNodes, MaxEdges>::for_each_adjacent(const T& node_value, Function&& function) const
+{
+	const size_type from{ find_index(node_value) };
+	if (from == npos) return;
+	details::for_each_bit(m_adjacency[from], [this, &function](size_type index) { function(m_values[index]); });
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::reachable(const T& from_node_value, const T& to_node_value) const
+{
+	const size_type from{ find_index(from_node_value) };
+	const size_type to{ find_index(to_node_value) };
+	if (from == npos || to == npos) return false;
+
+	// Bit-parallel breadth-first search: expand the whole frontier per step.
+	row_type visited{};
+	details::set_bit(visited, from);
+	row_type frontier{ visited };
+	while (!details::test_bit(visited, to)) {
+		row_type next{};
+		details::for_each_bit(frontier, [this, &next](size_type index) { details::or_bits(next, m_adjacency[index]); });
+
+		bool grown{ false };
+		for (size_type word{ 0 }; word < words_per_row; ++word) {
+			frontier[word] = next[word] & ~visited[word];
+			visited[word] |= frontier[word];
+			grown = grown || frontier[word] != 0;
+		}
+		if (!grown) return false;
+	}
+	return true;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr std::optional<typename static_directed_graph<T, MaxNodes, MaxEdges>::index_array_type>
+static_directed_graph<T, MaxNodes, MaxEdges>::topological_order() const
+{
+	std::array<size_type, MaxNodes> in_degree{};
+	for (size_type from{ 0 }; from < m_size; ++from) {
+		details::for_each_bit(m_adjacency[from], [&in_degree](size_type to) { ++in_degree[to]; });
+	}
+
+	// The result doubles as the queue of nodes without remaining incoming edges.
+	index_array_type order{};
+	size_type tail{ 0 };
+	for (size_type index{ 0 }; index < m_size; ++index) {
+		if (in_degree[index] == 0) order[tail++] = index;
+	}
+	for (size_type head{ 0 }; head < tail; ++head) {
+		details::for_each_bit(m_adjacency[order[head]], [&](size_type to) {
+			if (--in_degree[to] == 0) order[tail++] = to;
+		});
+	}
+
+	if (tail != m_size) return std::nullopt;
+	return order;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::operator==(const static_directed_graph& rhs) const
+{
+	if (m_size != rhs.m_size || m_edgeCount != rhs.m_edgeCount) return false;
+
+	// Index in rhs of every node of this graph
+	std::array<size_type, MaxNodes> rhs_index{};
+	for (size_type index{ 0 }; index < m_size; ++index) {
+		rhs_index[index] = rhs.find_index(m_values[index]);
+		if (rhs_index[index] == npos) return false;
+	}
+	for (size_type from{ 0 }; from < m_size; ++from) {
+		for (size_type to{ 0 }; to < m_size; ++to) {
+			if (details::test_bit(m_adjacency[from], to) != details::test_bit(rhs.m_adjacency[rhs_index[from]], rhs_index[to])) return false;
+		}
+	}
+	return true;
+}
+
+template<typename T, size_t MaxNodes, size_t MaxEdges>
+inline constexpr bool static_directed_graph<T, MaxNodes, MaxEdges>::operator!=(const static_directed_graph& rhs) const
+{
+	return !(*this == rhs);
+}